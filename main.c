@@ -1,18 +1,40 @@
+#ifndef _WIN32
+#define _POSIX_C_SOURCE 200809L   /* fdopen, fchmod, poll, dprintf, sockets */
+#else
+#define _CRT_RAND_S               /* rand_s for session tokens */
+#endif
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <ctype.h>
 #include <stdbool.h>
+#include <stdarg.h>
 #include <time.h>
+#include <errno.h>
+#ifndef _WIN32
+#include <fcntl.h>
+#include <poll.h>
+#include <signal.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+enum { LIMIT_WITHDRAW = 0, LIMIT_TRANSFER = 1, LIMIT_KINDS = 2 };
+
 typedef struct {
     char username[64];
     char password[64];
     char account_id[8];     // 7 digits + null terminator
     char Pin[7];            // 6 digits + null terminator
     double balance;
-    int withdrawals_today;  // count of withdrawals today
+    int withdrawals_today;  // count of withdrawals + transfers today
     int failed_attempts;    // count of consecutive failed login attempts
     bool frozen;
+    int tier;                               // limit policy tier, 0 = standard
+    int kind_count_today[LIMIT_KINDS];      // operations today, per LIMIT_* kind
+    double kind_amount_today[LIMIT_KINDS];  // amount moved today, per LIMIT_* kind
 } Account;
 
 
@@ -93,6 +115,379 @@ static int find_account_by_id(const Account accounts[], int count, const char *i
     return -1;
 }
 
+/* ---------- replication log ----------
+   Every committed mutation is appended as one text line
+   "<seq> <op> <args...>" to each configured sink. A sink is either a
+   standby connection (--primary <socket>) or a journal file
+   (--journal <path>) kept for reconciliation.
+   A standby started with --standby <socket> listens on a Unix-domain
+   socket, accepts one primary, replays its stream continuously and is
+   promoted when the primary disconnects. It writes "<applied seq>" lines
+   back on the same connection, and the primary reports each standby's lag
+   as committed minus acknowledged. Lines are buffered and flushed every
+   batch_size records; with batch_size 1 (--sync) the primary waits after
+   every record until each standby has applied it, otherwise acks are
+   collected whenever they arrive (asynchronous). Journal files get no acks.
+   A sink whose write fails (the standby died) is dropped and reported as
+   lost; the primary keeps serving. A --sync standby that does not ack
+   within REPL_ACK_TIMEOUT_MS is reported as lagging and is not waited for
+   again until it has caught up.
+   Standby connections need POSIX sockets; on Windows only --journal works.
+   C records carry the account's credentials (password hex-encoded so it
+   may contain any character), so journal files and the standby socket are
+   created owner-only (0600).
+     C id username password pin   account created
+     D id amount                   deposit
+     W id amount                   withdraw
+     T from to amount              transfer
+     P id pin                      PIN changed
+     F id                          account frozen
+     L id tier                     limit tier changed
+     N day                         new day (withdrawal counters reset)
+     S n from to amount every due runs failures last_result last_day
+                                   standing order n scheduled or updated
+     X n                           standing order n cancelled or finished */
+#define MAX_REPLICAS 4
+#define REPL_ACK_TIMEOUT_MS 2000
+
+typedef struct {
+    FILE *sink[MAX_REPLICAS];       // NULL once the sink is lost
+    int sinks;
+    int batch_size;         // records per flush, 1 = synchronous
+    int pending;            // records written since the last flush
+    long committed_seq;     // last sequence number produced
+    long shipped_seq;       // last sequence number flushed to every sink
+    long applied_seq;       // last record replayed from a primary (standby only)
+    const char *name[MAX_REPLICAS]; // socket or journal path, for status
+    int ack_fd[MAX_REPLICAS];       // standby connection per sink, -1 = journal file
+    long acked_seq[MAX_REPLICAS];   // last seq the standby reported applied
+    char ack_buf[MAX_REPLICAS][32]; // partial ack line
+    int ack_len[MAX_REPLICAS];
+    bool lost[MAX_REPLICAS];        // write failed or connection closed
+    bool lagging[MAX_REPLICAS];     // missed the ack timeout, not waited for
+} ReplLog;
+
+static ReplLog g_repl = { .batch_size = 1 };
+
+// stop shipping to sink i after a failure; the rest keep going
+static void repl_drop(int i, const char *reason) {
+    if (g_repl.lost[i]) return;
+    printf("Replication: sink %d (%s) %s; marked lost.\n", i + 1, g_repl.name[i], reason);
+    if (g_repl.sink[i]) fclose(g_repl.sink[i]);
+    g_repl.sink[i] = NULL;
+#ifndef _WIN32
+    if (g_repl.ack_fd[i] >= 0) close(g_repl.ack_fd[i]);
+#endif
+    g_repl.ack_fd[i] = -1;
+    g_repl.lost[i] = true;
+    g_repl.lagging[i] = false;
+}
+
+/* collect acknowledgements from standbys; with wait set, block until every
+   standby has applied committed_seq, giving up on one that stays silent for
+   REPL_ACK_TIMEOUT_MS (it is marked lagging until it catches up) */
+static void repl_read_acks(bool wait) {
+#ifndef _WIN32
+    for (int i = 0; i < g_repl.sinks; ++i) {
+        while (g_repl.ack_fd[i] >= 0) {
+            if (wait && (g_repl.lagging[i] || g_repl.acked_seq[i] >= g_repl.committed_seq)) break;
+            if (wait) {
+                struct pollfd pfd = { g_repl.ack_fd[i], POLLIN, 0 };
+                if (poll(&pfd, 1, REPL_ACK_TIMEOUT_MS) == 0) {
+                    g_repl.lagging[i] = true;
+                    printf("Replication: standby %d (%s) has not acknowledged seq %ld; marked lagging.\n",
+                           i + 1, g_repl.name[i], g_repl.committed_seq);
+                    break;
+                }
+            }
+            char *buf = g_repl.ack_buf[i];
+            ssize_t n = read(g_repl.ack_fd[i], buf + g_repl.ack_len[i],
+                             sizeof(g_repl.ack_buf[i]) - 1 - (size_t)g_repl.ack_len[i]);
+            if (n > 0) {
+                int len = g_repl.ack_len[i] + (int)n, start = 0;
+                for (int k = 0; k < len; ++k) {
+                    if (buf[k] != '\n') continue;
+                    buf[k] = '\0';
+                    g_repl.acked_seq[i] = strtol(buf + start, NULL, 10);
+                    start = k + 1;
+                }
+                memmove(buf, buf + start, (size_t)(len - start));
+                g_repl.ack_len[i] = (len - start < (int)sizeof(g_repl.ack_buf[i]) - 1) ? len - start : 0;
+                if (g_repl.acked_seq[i] >= g_repl.committed_seq) g_repl.lagging[i] = false;
+            } else if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR)) {
+                if (!wait) break;
+            } else {
+                repl_drop(i, "closed its connection");
+            }
+        }
+    }
+#else
+    (void)wait;
+#endif
+}
+
+static void repl_add_sink(FILE *f, int conn_fd, const char *name) {
+    g_repl.sink[g_repl.sinks] = f;
+    g_repl.ack_fd[g_repl.sinks] = conn_fd;
+    g_repl.name[g_repl.sinks] = name;
+    g_repl.lost[g_repl.sinks] = false;
+    g_repl.lagging[g_repl.sinks] = false;
+    g_repl.sinks++;
+}
+
+// add a journal file sink, readable by the owner only
+static bool repl_open_journal(const char *path) {
+    if (g_repl.sinks >= MAX_REPLICAS) return false;
+#ifndef _WIN32
+    int fd = open(path, O_WRONLY | O_CREAT | O_TRUNC, 0600);
+    if (fd < 0) return false;
+    fchmod(fd, 0600);   /* O_CREAT's mode does not apply to existing files */
+    FILE *f = fdopen(fd, "w");
+    if (!f) { close(fd); return false; }
+#else
+    FILE *f = fopen(path, "w");
+    if (!f) return false;
+#endif
+    repl_add_sink(f, -1, path);
+    return true;
+}
+
+#ifndef _WIN32
+static bool unix_address(struct sockaddr_un *addr, const char *path) {
+    memset(addr, 0, sizeof(*addr));
+    if (strlen(path) >= sizeof(addr->sun_path)) return false;
+    addr->sun_family = AF_UNIX;
+    strcpy(addr->sun_path, path);
+    return true;
+}
+
+// connect to a standby listening on the Unix socket at path and add it as a sink
+static bool repl_connect_standby(const char *path) {
+    struct sockaddr_un addr;
+    if (g_repl.sinks >= MAX_REPLICAS || !unix_address(&addr, path)) return false;
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0) return false;
+    if (connect(fd, (struct sockaddr *)&addr, sizeof(addr)) != 0) {
+        close(fd);
+        return false;
+    }
+    /* records go out through a buffered stream on a dup; acks are read from fd */
+    int wfd = dup(fd);
+    FILE *f = (wfd >= 0) ? fdopen(wfd, "w") : NULL;
+    if (!f) {
+        if (wfd >= 0) close(wfd);
+        close(fd);
+        return false;
+    }
+    fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+    repl_add_sink(f, fd, path);
+    return true;
+}
+
+// listen on the Unix socket at path and accept one primary; returns the connection or -1
+static int repl_accept_primary(const char *path) {
+    struct sockaddr_un addr;
+    if (!unix_address(&addr, path)) return -1;
+    int lfd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (lfd < 0) return -1;
+    unlink(path);
+    mode_t old_mask = umask(077);   /* socket file owner-only from the start */
+    int ok = bind(lfd, (struct sockaddr *)&addr, sizeof(addr)) == 0 && listen(lfd, 1) == 0;
+    umask(old_mask);
+    int fd = ok ? accept(lfd, NULL, NULL) : -1;
+    close(lfd);
+    unlink(path);
+    return fd;
+}
+#endif
+
+// hex-encode s into out, which must hold 2 * strlen(s) + 1 chars
+static void hex_encode(const char *s, char *out) {
+    static const char digits[] = "0123456789abcdef";
+    for (; *s; ++s) {
+        *out++ = digits[(unsigned char)*s >> 4];
+        *out++ = digits[(unsigned char)*s & 0xf];
+    }
+    *out = '\0';
+}
+
+// decode hex into out (size outsz); false if malformed or too long
+static bool hex_decode(const char *hex, char *out, size_t outsz) {
+    size_t n = strlen(hex);
+    if (n % 2 != 0 || n / 2 >= outsz) return false;
+    for (size_t i = 0; i < n; i += 2) {
+        int v = 0;
+        for (int k = 0; k < 2; ++k) {
+            char c = hex[i + k];
+            if (!isxdigit((unsigned char)c)) return false;
+            v = v * 16 + (isdigit((unsigned char)c) ? c - '0' : tolower((unsigned char)c) - 'a' + 10);
+        }
+        if (v == 0) return false;
+        *out++ = (char)v;
+    }
+    *out = '\0';
+    return true;
+}
+
+static void repl_flush(void) {
+    for (int i = 0; i < g_repl.sinks; ++i) {
+        if (g_repl.sink[i] && fflush(g_repl.sink[i]) != 0) repl_drop(i, strerror(errno));
+    }
+    g_repl.pending = 0;
+    g_repl.shipped_seq = g_repl.committed_seq;
+    repl_read_acks(g_repl.batch_size <= 1);
+}
+
+static void repl_log(const char *fmt, ...) {
+    g_repl.committed_seq++;
+    if (g_repl.sinks == 0) {
+        g_repl.shipped_seq = g_repl.committed_seq;
+        return;
+    }
+    for (int i = 0; i < g_repl.sinks; ++i) {
+        if (!g_repl.sink[i]) continue;
+        va_list ap;
+        va_start(ap, fmt);
+        bool ok = fprintf(g_repl.sink[i], "%ld ", g_repl.committed_seq) >= 0
+               && vfprintf(g_repl.sink[i], fmt, ap) >= 0
+               && fputc('\n', g_repl.sink[i]) != EOF;
+        va_end(ap);
+        if (!ok) repl_drop(i, strerror(errno));
+    }
+    if (++g_repl.pending >= g_repl.batch_size) repl_flush();
+}
+
+static void repl_close(void) {
+    repl_flush();
+    for (int i = 0; i < g_repl.sinks; ++i) {
+        if (!g_repl.sink[i]) continue;
+        fclose(g_repl.sink[i]);   /* a standby sees EOF and takes over */
+#ifndef _WIN32
+        if (g_repl.ack_fd[i] >= 0) close(g_repl.ack_fd[i]);
+#endif
+    }
+    g_repl.sinks = 0;
+}
+
+/* ---------- limits engine ----------
+   Per-tier limit policies, compiled from a text file into a flat table that
+   withdraw and transfer_account consult. The file can be reloaded at runtime;
+   a bad file leaves the current table in place. Format, one rule per line:
+     <tier> withdraw|transfer <per-txn cap> <daily amount> <daily count>
+     <tier> combined <daily count>      (withdrawals + transfers together)
+   Tiers not mentioned keep the standard defaults below. */
+#define MAX_TIERS 4
+#define LIMITS_FILE "limits.cfg"
+
+typedef struct {
+    double per_txn_cap;     // largest single amount
+    double daily_amount;    // total amount per day
+    int daily_count;        // operations per day
+} LimitRule;
+
+typedef struct {
+    LimitRule rule[LIMIT_KINDS];
+    int combined_daily_count;
+} LimitPolicy;
+
+static const LimitPolicy default_policy = {
+    { { 500.0, 1500.0, 3 }, { 500.0, 1500.0, 3 } }, 3
+};
+
+static LimitPolicy g_limits[MAX_TIERS];
+
+static void limits_defaults(LimitPolicy table[]) {
+    for (int t = 0; t < MAX_TIERS; ++t) table[t] = default_policy;
+}
+
+/* (re)load policies from path into the live table
+   returns number of rules read, or:
+    -1 = file cannot be opened
+    -2 = malformed rule (line number printed, table unchanged) */
+static int limits_load(const char *path) {
+    FILE *f = fopen(path, "r");
+    if (!f) return -1;
+
+    LimitPolicy next[MAX_TIERS];
+    limits_defaults(next);
+    char line[128], kind[16];
+    int lineno = 0, rules = 0;
+#define RULE_END (end >= 0 && p[end] == '\0')
+    while (fgets(line, sizeof(line), f)) {
+        lineno++;
+        trim_newline(line);
+        char *p = line;
+        while (isspace((unsigned char)*p)) p++;
+        if (*p == '\0' || *p == '#') continue;
+
+        /* end is set only when the whole rule matched; anything after it
+           but whitespace makes the line invalid */
+        int tier, cnt, n, end = -1;
+        double cap, daily;
+        n = sscanf(p, "%d %15s %lf %lf %d %n", &tier, kind, &cap, &daily, &cnt, &end);
+        bool ok = n >= 2 && tier >= 0 && tier < MAX_TIERS;
+        if (ok && strcmp(kind, "combined") == 0) {
+            end = -1;
+            ok = sscanf(p, "%*d %*s %d %n", &cnt, &end) == 1 && RULE_END && cnt >= 0;
+            if (ok) next[tier].combined_daily_count = cnt;
+        } else if (ok && (strcmp(kind, "withdraw") == 0 || strcmp(kind, "transfer") == 0)) {
+            ok = n == 5 && RULE_END && cap > 0.0 && daily > 0.0 && cnt >= 0;
+            if (ok) {
+                LimitRule r = { cap, daily, cnt };
+                next[tier].rule[kind[0] == 'w' ? LIMIT_WITHDRAW : LIMIT_TRANSFER] = r;
+            }
+        } else {
+            ok = false;
+        }
+        if (!ok) {
+            printf("%s:%d: invalid limit rule.\n", path, lineno);
+            fclose(f);
+            return -2;
+        }
+        rules++;
+    }
+#undef RULE_END
+    fclose(f);
+    memcpy(g_limits, next, sizeof(g_limits));
+    return rules;
+}
+
+static const LimitPolicy *limits_policy(const Account *a) {
+    return &g_limits[(a->tier >= 0 && a->tier < MAX_TIERS) ? a->tier : 0];
+}
+
+/* check an operation of the given kind against the account's tier
+   returns 0 if allowed, else the first violated rule:
+    -6 = amount over per-transaction cap
+    -5 = daily count for this kind reached
+    -9 = daily amount budget exceeded
+   -10 = combined withdrawal/transfer count reached */
+static int limits_check(const Account *a, int kind, double amount) {
+    static const int verdict[8] = { 0, -6, -5, -6, -9, -6, -5, -6 };
+    const LimitPolicy *p = limits_policy(a);
+    const LimitRule *r = &p->rule[kind];
+    int over_cap = amount > r->per_txn_cap;
+    int over_kind = a->kind_count_today[kind] >= r->daily_count;
+    int over_count = over_kind | (a->withdrawals_today >= p->combined_daily_count);
+    int over_amount = a->kind_amount_today[kind] + amount > r->daily_amount;
+    int res = verdict[over_cap | over_count << 1 | over_amount << 2];
+    return (res == -5 && !over_kind) ? -10 : res;
+}
+
+static void limits_commit(Account *a, int kind, double amount) {
+    a->withdrawals_today += 1;
+    a->kind_count_today[kind] += 1;
+    a->kind_amount_today[kind] += amount;
+}
+
+static void limits_reset_day(Account *a) {
+    a->withdrawals_today = 0;
+    for (int k = 0; k < LIMIT_KINDS; ++k) {
+        a->kind_count_today[k] = 0;
+        a->kind_amount_today[k] = 0.0;
+    }
+}
+
 /* deposit amount into account identified by account_id
    returns:
      0 = success
@@ -104,6 +499,7 @@ static int deposit(Account accounts[], int count, const char *account_id, double
     int idx = find_account_by_id(accounts, count, account_id);
     if (idx < 0) return -1;
     accounts[idx].balance += amount;
+    repl_log("D %s %.17g", accounts[idx].account_id, amount);
     return 0;
 }
 // interactive deposit prompt (PIN required)
@@ -159,19 +555,22 @@ static void deposit_prompt(Account accounts[], int count) {
     -2 = invalid amount (<= 0)
     -3 = insufficient funds
     -4 = incorrect PIN
-    -5 = daily withdrawal limit reached
-    -6 = amount exceeds per-withdrawal limit (500)
+    -5 = daily withdrawal count reached (tier policy)
+    -6 = amount exceeds per-withdrawal cap (tier policy)
+    -9 = daily withdrawal amount exceeded (tier policy)
+   -10 = combined withdrawal/transfer count reached (tier policy)
 */
 static int withdraw(Account accounts[], int count, const char *account_id, const char *pin, double amount) {
     if (amount <= 0.0) return -2;
-    if (amount > 500.0) return -6; /* enforce per-withdrawal cap */
     int idx = find_account_by_id(accounts, count, account_id);
     if (idx < 0) return -1;
     if (!pin || strcmp(accounts[idx].Pin, pin) != 0) return -4;
-    if (accounts[idx].withdrawals_today >= 3) return -5; /* daily limit */
+    int lim = limits_check(&accounts[idx], LIMIT_WITHDRAW, amount);
+    if (lim != 0) return lim;
     if (accounts[idx].balance < amount) return -3;
     accounts[idx].balance -= amount;
-    accounts[idx].withdrawals_today += 1;
+    limits_commit(&accounts[idx], LIMIT_WITHDRAW, amount);
+    repl_log("W %s %.17g", accounts[idx].account_id, amount);
     return 0;
 }
 
@@ -200,7 +599,8 @@ static void withdraw_prompt(Account accounts[], int count) {
         return;
     }
 
-    printf("Enter withdrawal amount (> 0, max 500): ");
+    const LimitRule *wr = &limits_policy(&accounts[idx])->rule[LIMIT_WITHDRAW];
+    printf("Enter withdrawal amount (> 0, max %.2f): ", wr->per_txn_cap);
     if (!fgets(buf, sizeof(buf), stdin)) { printf("Input error.\n"); return; }
     trim_newline(buf);
     char *endptr;
@@ -216,9 +616,14 @@ static void withdraw_prompt(Account accounts[], int count) {
     } else if (res == -3) {
         printf("Withdrawal failed: insufficient funds. Current balance: %.2f\n", accounts[idx].balance);
     } else if (res == -5) {
-        printf("Withdrawal failed: daily withdrawal limit (3) reached for this account.\n");
+        printf("Withdrawal failed: daily withdrawal limit (%d) reached for this account.\n", wr->daily_count);
+    } else if (res == -10) {
+        printf("Withdrawal failed: combined daily withdrawal/transfer limit (%d) reached for this account.\n",
+               limits_policy(&accounts[idx])->combined_daily_count);
     } else if (res == -6) {
-        printf("Withdrawal failed: amount exceeds per-withdrawal limit of 500.\n");
+        printf("Withdrawal failed: amount exceeds per-withdrawal limit of %.2f.\n", wr->per_txn_cap);
+    } else if (res == -9) {
+        printf("Withdrawal failed: daily withdrawal amount of %.2f would be exceeded.\n", wr->daily_amount);
     } else {
         printf("Withdrawal failed (code %d).\n", res);
     }
@@ -266,6 +671,7 @@ static int login_prompt(Account accounts[], int count) {
                 int remaining = 3 - accounts[idx].failed_attempts;
                 if (accounts[idx].failed_attempts >= 3) {
                     accounts[idx].frozen = true;
+                    repl_log("F %s", accounts[idx].account_id);
                     printf("Incorrect password. Account %s has been frozen after 3 failed attempts.\n", accid);
                     return -1;
                 } else {
@@ -371,14 +777,31 @@ static int create_account_prompt(Account accounts[], int *account_count) {
 
     accounts[*account_count] = a;
     int idx = (*account_count)++;
+    char pwd_hex[2 * sizeof(a.password) + 1];
+    hex_encode(a.password, pwd_hex);
+    repl_log("C %s %s %s %s", a.account_id, a.username, pwd_hex, a.Pin);
     printf("Account created successfully! Username: %s  Account ID: %s\n", a.username, a.account_id);
     return idx;
 }
 
+/* Move amount between two resolved accounts after the caller has
+   authorised it. Applies the tier limits and the funds check only;
+   returns 0 or the -3/-5/-6/-9/-10 codes of transfer_account */
+static int transfer_funds(Account accounts[], int idx_from, int idx_to, double amount) {
+    int lim = limits_check(&accounts[idx_from], LIMIT_TRANSFER, amount);
+    if (lim != 0) return lim;
+    if (accounts[idx_from].balance < amount) return -3;
+
+    accounts[idx_from].balance -= amount;
+    accounts[idx_to].balance += amount;
+    limits_commit(&accounts[idx_from], LIMIT_TRANSFER, amount);
+    repl_log("T %s %s %.17g", accounts[idx_from].account_id, accounts[idx_to].account_id, amount);
+    return 0;
+}
+
 /* Transfer amount from one account to another, verified by source PIN.
-   Enforces same daily rules as withdraw for the source account:
-     - max 3 withdrawals/transfers per day
-     - max amount per single transfer: 500
+   Enforces the source account's tier transfer rules (per-transfer cap,
+   daily count and amount) plus the combined withdrawal/transfer count.
    Return codes:
      0 = success
     -1 = source account not found
@@ -386,15 +809,16 @@ static int create_account_prompt(Account accounts[], int *account_count) {
     -2 = invalid amount (<= 0)
     -3 = insufficient funds
     -4 = incorrect PIN
-    -5 = daily withdrawal limit reached (3)
-    -6 = amount exceeds per-transfer limit (500)
+    -5 = daily transfer count reached
+    -6 = amount exceeds per-transfer cap
+    -9 = daily transfer amount exceeded
+   -10 = combined withdrawal/transfer count reached
 */
 static int transfer_account(Account accounts[], int count,
                             const char *from_id, const char *pin,
                             const char *to_id, double amount)
 {
     if (amount <= 0.0) return -2;
-    if (amount > 500.0) return -6; /* per-transfer cap */
 
     int idx_from = find_account_by_id(accounts, count, from_id);
     if (idx_from < 0) return -1;
@@ -403,18 +827,450 @@ static int transfer_account(Account accounts[], int count,
     if (idx_to < 0) return -7;
 
     if (!pin || strcmp(accounts[idx_from].Pin, pin) != 0) return -4;
-    if (accounts[idx_from].withdrawals_today >= 3) return -5;
-    if (accounts[idx_from].balance < amount) return -3;
+    return transfer_funds(accounts, idx_from, idx_to, amount);
+}
 
-    accounts[idx_from].balance -= amount;
-    accounts[idx_to].balance += amount;
-    accounts[idx_from].withdrawals_today += 1;
+/* ---------- scheduled transfers / standing orders ----------
+   Orders live in a day-granular timer wheel: order i sits in bucket
+   (due_day % WHEEL_SLOTS), chained through .next. On each simulated day
+   only that bucket is walked; orders due further out than one wheel
+   revolution simply stay in the bucket until their round comes up. */
+#define MAX_ORDERS 1024
+#define WHEEL_SLOTS 64
+
+typedef struct {
+    char from_id[8];
+    char to_id[8];
+    double amount;
+    int interval_days;      // 0 = one-off scheduled transfer, >0 = repeat every N days
+    int due_day;            // simulated day on which the order next runs
+    int next;               // next order in the same wheel bucket (or free list), -1 = end
+    int runs;               // successful executions
+    int failures;           // failed executions (insufficient funds, daily limit, ...)
+    int last_result;        // last transfer_account return code
+    int last_day;           // day of the last execution attempt, -1 = never ran
+    bool active;
+} StandingOrder;
+
+typedef struct {
+    StandingOrder orders[MAX_ORDERS];
+    int bucket[WHEEL_SLOTS];    // head order index per wheel slot, -1 = empty
+    int free_head;              // recycled order slots, -1 = none
+    int used;                   // high-water mark of orders[]
+    int today;                  // current simulated day
+} OrderBook;
+
+static void order_book_init(OrderBook *book) {
+    for (int s = 0; s < WHEEL_SLOTS; ++s) book->bucket[s] = -1;
+    book->free_head = -1;
+    book->used = 0;
+    book->today = 0;
+}
+
+static void order_wheel_insert(OrderBook *book, int i) {
+    int s = book->orders[i].due_day % WHEEL_SLOTS;
+    book->orders[i].next = book->bucket[s];
+    book->bucket[s] = i;
+}
+
+// journal the full state of order i, so a standby holds the same order book
+static void order_log(const OrderBook *book, int i) {
+    const StandingOrder *o = &book->orders[i];
+    repl_log("S %d %s %s %.17g %d %d %d %d %d %d", i, o->from_id, o->to_id, o->amount,
+             o->interval_days, o->due_day, o->runs, o->failures, o->last_result, o->last_day);
+}
+
+/* relink the wheel and free list from orders[0..used), e.g. after a standby
+   has filled orders[] from S/X records */
+static void order_book_rebuild(OrderBook *book) {
+    for (int s = 0; s < WHEEL_SLOTS; ++s) book->bucket[s] = -1;
+    book->free_head = -1;
+    for (int i = book->used - 1; i >= 0; --i) {
+        if (book->orders[i].active) {
+            order_wheel_insert(book, i);
+        } else {
+            book->orders[i].next = book->free_head;
+            book->free_head = i;
+        }
+    }
+}
+
+static void order_release(OrderBook *book, int i) {
+    book->orders[i].active = false;
+    book->orders[i].next = book->free_head;
+    book->free_head = i;
+}
+
+/* add a scheduled transfer starting in start_in_days (>= 1) days
+   returns order index, or:
+    -1 = order book full
+    -2 = invalid amount / schedule */
+static int schedule_order(OrderBook *book, const char *from_id, const char *to_id,
+                          double amount, int start_in_days, int interval_days)
+{
+    if (amount <= 0.0 || start_in_days < 1 || interval_days < 0) return -2;
+
+    int i;
+    if (book->free_head >= 0) {
+        i = book->free_head;
+        book->free_head = book->orders[i].next;
+    } else if (book->used < MAX_ORDERS) {
+        i = book->used++;
+    } else {
+        return -1;
+    }
+
+    StandingOrder o = {0};
+    strncpy(o.from_id, from_id, sizeof(o.from_id) - 1);
+    strncpy(o.to_id, to_id, sizeof(o.to_id) - 1);
+    o.amount = amount;
+    o.interval_days = interval_days;
+    o.due_day = book->today + start_in_days;
+    o.last_result = 0;
+    o.last_day = -1;
+    o.active = true;
+    book->orders[i] = o;
+    order_wheel_insert(book, i);
+    order_log(book, i);
+    return i;
+}
+
+/* cancelled orders are unlinked lazily when their bucket is next walked */
+static void cancel_order(OrderBook *book, int i) {
+    if (i < 0 || i >= book->used || !book->orders[i].active) return;
+    book->orders[i].active = false;
+    repl_log("X %d", i);
+}
+
+static const char *transfer_result_text(int res) {
+    switch (res) {
+        case 0:  return "ok";
+        case -1: return "source account not found";
+        case -2: return "invalid amount";
+        case -3: return "insufficient funds";
+        case -4: return "incorrect PIN";
+        case -5: return "daily transfer count limit reached";
+        case -6: return "amount over per-transfer limit";
+        case -7: return "destination account not found";
+        case -9: return "daily amount limit reached";
+        case -10: return "combined daily count limit reached";
+        default: return "failed";
+    }
+}
+
+/* Execute every order due on book->today through transfer_funds.
+   Orders were authorised by the owner's PIN when they were scheduled, so
+   no PIN check happens here. Daily limits and funds are checked as usual
+   and the outcome is recorded on the order.
+   returns number of orders executed (successful or not) */
+static int run_due_orders(OrderBook *book, Account accounts[], int count) {
+    int s = book->today % WHEEL_SLOTS;
+    int i = book->bucket[s];
+    int executed = 0;
+    book->bucket[s] = -1;   /* detach; survivors and repeats are re-linked */
+
+    while (i >= 0) {
+        StandingOrder *o = &book->orders[i];
+        int next = o->next;
+
+        if (!o->active) {
+            order_release(book, i);
+        } else if (o->due_day > book->today) {
+            order_wheel_insert(book, i);   /* due in a later revolution */
+        } else {
+            int from = find_account_by_id(accounts, count, o->from_id);
+            int to = find_account_by_id(accounts, count, o->to_id);
+            int res = (from < 0) ? -1
+                    : (to < 0) ? -7
+                    : transfer_funds(accounts, from, to, o->amount);
+            o->last_result = res;
+            o->last_day = book->today;
+            if (res == 0) {
+                o->runs++;
+            } else {
+                o->failures++;
+                printf("Order #%d (%s -> %s, %.2f) failed: %s.\n",
+                       i + 1, o->from_id, o->to_id, o->amount, transfer_result_text(res));
+            }
+            executed++;
+
+            if (o->interval_days > 0) {
+                o->due_day = book->today + o->interval_days;
+                order_wheel_insert(book, i);
+                order_log(book, i);
+            } else {
+                order_release(book, i);
+                repl_log("X %d", i);
+            }
+        }
+        i = next;
+    }
+    return executed;
+}
+
+// interactive prompt to schedule a transfer from the logged-in account (PIN required)
+static void schedule_order_prompt(OrderBook *book, Account accounts[], int count, int logged) {
+    char pin_buf[16], to_accid[16], buf[64];
+    char *endptr;
+
+    printf("\n--- Schedule Transfer ---\n");
+    printf("Enter your 6-digit PIN: ");
+    if (!fgets(pin_buf, sizeof(pin_buf), stdin)) { printf("Input error.\n"); return; }
+    trim_newline(pin_buf);
+    if (strlen(pin_buf) != 6 || strcmp(accounts[logged].Pin, pin_buf) != 0) {
+        printf("Incorrect PIN. Scheduling cancelled.\n");
+        return;
+    }
+
+    printf("Enter destination 7-digit Account ID: ");
+    if (!fgets(to_accid, sizeof(to_accid), stdin)) { printf("Input error.\n"); return; }
+    trim_newline(to_accid);
+    if (!is_valid_account_id(to_accid)) { printf("Invalid destination account ID format.\n"); return; }
+    if (find_account_by_id(accounts, count, to_accid) < 0) { printf("Destination account not found.\n"); return; }
+    if (strcmp(to_accid, accounts[logged].account_id) == 0) { printf("Cannot transfer to the same account.\n"); return; }
+
+    printf("Enter transfer amount (> 0, max %.2f): ", limits_policy(&accounts[logged])->rule[LIMIT_TRANSFER].per_txn_cap);
+    if (!fgets(buf, sizeof(buf), stdin)) { printf("Input error.\n"); return; }
+    trim_newline(buf);
+    double amt = strtod(buf, &endptr);
+    if (endptr == buf || amt <= 0.0) { printf("Invalid amount.\n"); return; }
+
+    printf("First run in how many days (>= 1): ");
+    if (!fgets(buf, sizeof(buf), stdin)) { printf("Input error.\n"); return; }
+    trim_newline(buf);
+    long start = strtol(buf, &endptr, 10);
+    if (endptr == buf || start < 1 || start > 3650) { printf("Invalid start day.\n"); return; }
+
+    printf("Repeat every how many days (0 = run once): ");
+    if (!fgets(buf, sizeof(buf), stdin)) { printf("Input error.\n"); return; }
+    trim_newline(buf);
+    long every = strtol(buf, &endptr, 10);
+    if (endptr == buf || every < 0 || every > 3650) { printf("Invalid interval.\n"); return; }
+
+    int id = schedule_order(book, accounts[logged].account_id, to_accid, amt, (int)start, (int)every);
+    if (id == -1) {
+        printf("Scheduling failed: order book is full.\n");
+    } else if (id < 0) {
+        printf("Scheduling failed (code %d).\n", id);
+    } else {
+        printf("Order #%d scheduled: %.2f to %s on day %d", id + 1, amt, to_accid, book->orders[id].due_day);
+        if (every > 0) printf(", then every %ld day(s)", every);
+        printf(".\n");
+    }
+}
+
+// list the logged-in account's scheduled orders and optionally cancel one
+static void manage_orders_prompt(OrderBook *book, const Account accounts[], int logged) {
+    char buf[16];
+    int shown = 0;
+
+    printf("\n--- Scheduled Transfers (today is day %d) ---\n", book->today);
+    for (int i = 0; i < book->used; ++i) {
+        const StandingOrder *o = &book->orders[i];
+        if (!o->active || strcmp(o->from_id, accounts[logged].account_id) != 0) continue;
+        printf("#%d: %.2f to %s, next day %d, ", i + 1, o->amount, o->to_id, o->due_day);
+        if (o->interval_days > 0) printf("every %d day(s)", o->interval_days);
+        else printf("once");
+        printf(" | runs %d, failures %d", o->runs, o->failures);
+        if (o->last_day >= 0) printf(", last (day %d): %s", o->last_day, transfer_result_text(o->last_result));
+        printf("\n");
+        shown++;
+    }
+    if (shown == 0) {
+        printf("No scheduled transfers.\n");
+        return;
+    }
+
+    printf("Enter order number to cancel (blank to keep all): ");
+    if (!fgets(buf, sizeof(buf), stdin)) { printf("Input error.\n"); return; }
+    trim_newline(buf);
+    if (buf[0] == '\0') return;
+    int n = atoi(buf) - 1;
+    if (n < 0 || n >= book->used || !book->orders[n].active ||
+        strcmp(book->orders[n].from_id, accounts[logged].account_id) != 0) {
+        printf("No such order.\n");
+        return;
+    }
+    cancel_order(book, n);
+    printf("Order #%d cancelled.\n", n + 1);
+}
+
+/* ---------- sessions ----------
+   Fixed pool of login sessions addressed by opaque 64-bit tokens. The low
+   bits of a token name its pool slot, so lookup is a single compare; the
+   rest comes from the OS random source (/dev/urandom, or rand_s on
+   Windows), so a stale or guessed token does not resolve. Live
+   sessions sit on an idle list ordered by last activity (touching one moves
+   it to the tail), so expiry only ever inspects the head. */
+#define SESSION_SLOT_BITS 4
+#define MAX_SESSIONS (1 << SESSION_SLOT_BITS)
+#define SESSION_IDLE_SECONDS 300
+
+typedef unsigned long long SessionToken;    // 0 = no session
+
+typedef struct {
+    SessionToken token;     // 0 = slot free
+    int account;            // index into accounts[]
+    time_t last_active;
+    int prev, next;         // idle list neighbours; .next also chains the free list
+} Session;
+
+typedef struct {
+    Session pool[MAX_SESSIONS];
+    int free_head;
+    int idle_head;          // least recently active session, -1 = none
+    int idle_tail;          // most recently active session
+} SessionTable;
+
+static void session_table_init(SessionTable *t) {
+    for (int i = 0; i < MAX_SESSIONS; ++i) {
+        t->pool[i].token = 0;
+        t->pool[i].next = (i + 1 < MAX_SESSIONS) ? i + 1 : -1;
+    }
+    t->free_head = 0;
+    t->idle_head = t->idle_tail = -1;
+}
+
+static void session_unlink(SessionTable *t, int i) {
+    Session *s = &t->pool[i];
+    if (s->prev >= 0) t->pool[s->prev].next = s->next; else t->idle_head = s->next;
+    if (s->next >= 0) t->pool[s->next].prev = s->prev; else t->idle_tail = s->prev;
+}
+
+static void session_append(SessionTable *t, int i) {
+    t->pool[i].prev = t->idle_tail;
+    t->pool[i].next = -1;
+    if (t->idle_tail >= 0) t->pool[t->idle_tail].next = i; else t->idle_head = i;
+    t->idle_tail = i;
+}
+
+static void session_release(SessionTable *t, int i) {
+    session_unlink(t, i);
+    t->pool[i].token = 0;
+    t->pool[i].next = t->free_head;
+    t->free_head = i;
+}
+
+// end every session idle for SESSION_IDLE_SECONDS or more
+static void session_expire(SessionTable *t, time_t now) {
+    while (t->idle_head >= 0 && now - t->pool[t->idle_head].last_active >= SESSION_IDLE_SECONDS) {
+        session_release(t, t->idle_head);
+    }
+}
+
+/* fill *out with unpredictable bits from the OS; rand() is seeded with the
+   clock and would make tokens guessable, so there is no fallback to it */
+static bool session_random(SessionToken *out) {
+#ifndef _WIN32
+    FILE *f = fopen("/dev/urandom", "rb");
+    if (!f) return false;
+    bool ok = fread(out, sizeof(*out), 1, f) == 1;
+    fclose(f);
+    return ok;
+#else
+    unsigned int hi, lo;
+    if (rand_s(&hi) != 0 || rand_s(&lo) != 0) return false;
+    *out = ((SessionToken)hi << 32) | lo;
+    return true;
+#endif
+}
+
+/* start a session for accounts[account]
+   returns its token, or 0 if the table is full or no random token is available */
+static SessionToken session_open(SessionTable *t, int account) {
+    time_t now = time(NULL);
+    session_expire(t, now);
+    if (t->free_head < 0) return 0;
+
+    SessionToken r;
+    if (!session_random(&r)) return 0;
+    int i = t->free_head;
+    t->free_head = t->pool[i].next;
+
+    if (r == 0) r = 1;
+    t->pool[i].token = (r << SESSION_SLOT_BITS) | (SessionToken)i;
+    t->pool[i].account = account;
+    t->pool[i].last_active = now;
+    session_append(t, i);
+    return t->pool[i].token;
+}
+
+static void session_close(SessionTable *t, SessionToken token) {
+    int i = (int)(token & (MAX_SESSIONS - 1));
+    if (token != 0 && t->pool[i].token == token) session_release(t, i);
+}
+
+/* resolve a token to its account index and mark the session active
+   returns -1 if the token is invalid or expired; a session whose account
+   has since been frozen is ended and also yields -1 */
+static int session_account(SessionTable *t, const Account accounts[], SessionToken token) {
+    time_t now = time(NULL);
+    session_expire(t, now);
+    int i = (int)(token & (MAX_SESSIONS - 1));
+    if (token == 0 || t->pool[i].token != token) return -1;
+    if (accounts[t->pool[i].account].frozen) {
+        session_release(t, i);
+        return -1;
+    }
+    t->pool[i].last_active = now;
+    session_unlink(t, i);
+    session_append(t, i);
+    return t->pool[i].account;
+}
+
+/* Post-login operations addressed by session token. They return the same
+   codes as the underlying operation, plus:
+    -8 = invalid or expired session, or account frozen */
+static int session_transfer(SessionTable *t, Account accounts[], int count, SessionToken token,
+                            const char *pin, const char *to_id, double amount) {
+    int idx = session_account(t, accounts, token);
+    if (idx < 0) return -8;
+    return transfer_account(accounts, count, accounts[idx].account_id, pin, to_id, amount);
+}
+
+static int session_withdraw(SessionTable *t, Account accounts[], int count, SessionToken token,
+                            const char *pin, double amount) {
+    int idx = session_account(t, accounts, token);
+    if (idx < 0) return -8;
+    return withdraw(accounts, count, accounts[idx].account_id, pin, amount);
+}
+
+// -4 = incorrect PIN
+static int session_deposit(SessionTable *t, Account accounts[], int count, SessionToken token,
+                           const char *pin, double amount) {
+    int idx = session_account(t, accounts, token);
+    if (idx < 0) return -8;
+    if (!pin || strcmp(accounts[idx].Pin, pin) != 0) return -4;
+    return deposit(accounts, count, accounts[idx].account_id, amount);
+}
+
+static int session_balance(SessionTable *t, const Account accounts[], SessionToken token, double *balance) {
+    int idx = session_account(t, accounts, token);
+    if (idx < 0) return -8;
+    *balance = accounts[idx].balance;
     return 0;
 }
 
+// -4 = incorrect current PIN, -2 = new PIN not 6 digits
+static int session_change_pin(SessionTable *t, Account accounts[], SessionToken token,
+                              const char *old_pin, const char *new_pin) {
+    int idx = session_account(t, accounts, token);
+    if (idx < 0) return -8;
+    if (!old_pin || strcmp(accounts[idx].Pin, old_pin) != 0) return -4;
+    bool ok = new_pin && strlen(new_pin) == 6;
+    for (size_t i = 0; ok && i < 6; ++i) {
+        if (!isdigit((unsigned char)new_pin[i])) ok = false;
+    }
+    if (!ok) return -2;
+    strncpy(accounts[idx].Pin, new_pin, sizeof(accounts[idx].Pin) - 1);
+    accounts[idx].Pin[6] = '\0';
+    repl_log("P %s %s", accounts[idx].account_id, accounts[idx].Pin);
+    return 0;
+}
 
 // change PIN for logged-in account (verify old PIN, require confirmation) 
-static void change_pin_prompt(Account accounts[], int idx) {
+static void change_pin_prompt(SessionTable *sessions, Account accounts[], SessionToken token) {
+    int idx = session_account(sessions, accounts, token);
     if (idx < 0) return;
     char old_pin[16];
     char new_pin[16];
@@ -455,10 +1311,9 @@ static void change_pin_prompt(Account accounts[], int idx) {
             continue;
         }
 
-        /* success: store new PIN */
-        strncpy(accounts[idx].Pin, new_pin, sizeof(accounts[idx].Pin) - 1);
-        accounts[idx].Pin[6] = '\0';
-        printf("PIN changed successfully.\n");
+        int res = session_change_pin(sessions, accounts, token, old_pin, new_pin);
+        if (res == 0) printf("PIN changed successfully.\n");
+        else printf("PIN change failed (code %d).\n", res);
         break;
     }
 }
@@ -514,24 +1369,415 @@ static void manage_pin_prompt(Account accounts[], int idx) {
         /* success: store new PIN */
         strncpy(accounts[idx].Pin, new_pin, sizeof(accounts[idx].Pin) - 1);
         accounts[idx].Pin[6] = '\0';
+        repl_log("P %s %s", accounts[idx].account_id, accounts[idx].Pin);
         printf("PIN managed successfully.\n");
         break;
     }
 }
 
+/* apply one replicated record to a store; with forward set it is also passed
+   on to this process's own sinks, so standbys can be chained. S/X records
+   only fill book->orders[]; call order_book_rebuild before running orders.
+   book may be NULL, in which case order records and the day number are
+   accepted but ignored
+   returns the record's sequence number, or -1 if malformed/not applicable */
+static long repl_apply(Account accounts[], int *count, OrderBook *book, const char *line, bool forward) {
+    long seq;
+    char op;
+    int op_at = 0;
+    if (sscanf(line, "%ld %n%c", &seq, &op_at, &op) != 2) return -1;
+    const char *args = line + op_at + 1;
+
+    char id[16], id2[16], user[64], pwd_hex[160], pwd[64], pin[16];
+    double amt;
+    int i, j, day;
+    int end = -1;   /* set by a trailing %n only if every field matched */
+
+    /* each record must match its field list exactly; trailing tokens are rejected */
+#define RECORD_END (end >= 0 && args[end] == '\0')
+
+    if (op == 'C') {
+        if (sscanf(args, "%15s %63s %159s %15s %n", id, user, pwd_hex, pin, &end) != 4 || !RECORD_END) return -1;
+        if (!is_valid_account_id(id) || !is_valid_username(user) || strlen(pin) != 6) return -1;
+        if (!hex_decode(pwd_hex, pwd, sizeof(pwd))) return -1;
+        if (*count >= MAX_ACCOUNTS || account_id_exists(accounts, *count, id)) return -1;
+        Account a = {0};
+        strncpy(a.account_id, id, sizeof(a.account_id) - 1);
+        strncpy(a.username, user, sizeof(a.username) - 1);
+        strncpy(a.password, pwd, sizeof(a.password) - 1);
+        strncpy(a.Pin, pin, sizeof(a.Pin) - 1);
+        accounts[(*count)++] = a;
+    } else if (op == 'D' || op == 'W') {
+        if (sscanf(args, "%15s %lf %n", id, &amt, &end) != 2 || !RECORD_END) return -1;
+        if ((i = find_account_by_id(accounts, *count, id)) < 0) return -1;
+        if (op == 'D') {
+            accounts[i].balance += amt;
+        } else {
+            accounts[i].balance -= amt;
+            limits_commit(&accounts[i], LIMIT_WITHDRAW, amt);
+        }
+    } else if (op == 'T') {
+        if (sscanf(args, "%15s %15s %lf %n", id, id2, &amt, &end) != 3 || !RECORD_END) return -1;
+        if ((i = find_account_by_id(accounts, *count, id)) < 0) return -1;
+        if ((j = find_account_by_id(accounts, *count, id2)) < 0) return -1;
+        accounts[i].balance -= amt;
+        accounts[j].balance += amt;
+        limits_commit(&accounts[i], LIMIT_TRANSFER, amt);
+    } else if (op == 'P') {
+        if (sscanf(args, "%15s %15s %n", id, pin, &end) != 2 || !RECORD_END || strlen(pin) != 6) return -1;
+        if ((i = find_account_by_id(accounts, *count, id)) < 0) return -1;
+        strncpy(accounts[i].Pin, pin, sizeof(accounts[i].Pin) - 1);
+        accounts[i].Pin[6] = '\0';
+    } else if (op == 'F') {
+        if (sscanf(args, "%15s %n", id, &end) != 1 || !RECORD_END) return -1;
+        if ((i = find_account_by_id(accounts, *count, id)) < 0) return -1;
+        accounts[i].frozen = true;
+        accounts[i].failed_attempts = 3;
+    } else if (op == 'L') {
+        if (sscanf(args, "%15s %d %n", id, &day, &end) != 2 || !RECORD_END) return -1;
+        if (day < 0 || day >= MAX_TIERS) return -1;
+        if ((i = find_account_by_id(accounts, *count, id)) < 0) return -1;
+        accounts[i].tier = day;
+    } else if (op == 'N') {
+        if (sscanf(args, "%d %n", &day, &end) != 1 || !RECORD_END) return -1;
+        for (i = 0; i < *count; ++i) limits_reset_day(&accounts[i]);
+        if (book) book->today = day;
+    } else if (op == 'S') {
+        StandingOrder o = {0};
+        if (sscanf(args, "%d %15s %15s %lf %d %d %d %d %d %d %n", &i, id, id2, &o.amount,
+                   &o.interval_days, &o.due_day, &o.runs, &o.failures, &o.last_result,
+                   &o.last_day, &end) != 10 || !RECORD_END) return -1;
+        if (i < 0 || i >= MAX_ORDERS || !is_valid_account_id(id) || !is_valid_account_id(id2)) return -1;
+        if (book) {
+            strncpy(o.from_id, id, sizeof(o.from_id) - 1);
+            strncpy(o.to_id, id2, sizeof(o.to_id) - 1);
+            o.next = -1;
+            o.active = true;
+            book->orders[i] = o;
+            if (i >= book->used) book->used = i + 1;
+        }
+    } else if (op == 'X') {
+        if (sscanf(args, "%d %n", &i, &end) != 1 || !RECORD_END || i < 0 || i >= MAX_ORDERS) return -1;
+        if (book && i < book->used) book->orders[i].active = false;
+    } else {
+        return -1;
+    }
+#undef RECORD_END
+
+    if (forward) repl_log("%s", line + op_at);   /* "<op> <args>" unchanged */
+    return seq;
+}
+
+/* standby mode: wait for a primary on the Unix socket at path, replay its
+   stream until it disconnects, then return so the caller can carry on as
+   the promoted primary */
+static void run_standby(const char *path, Account accounts[], int *count, OrderBook *book) {
+#ifndef _WIN32
+    printf("Standby: waiting for a primary on %s ...\n", path);
+    int fd = repl_accept_primary(path);
+    FILE *in = (fd >= 0) ? fdopen(fd, "r") : NULL;
+    if (!in) {
+        printf("Standby: cannot accept a primary on %s.\n", path);
+        if (fd >= 0) close(fd);
+        return;
+    }
+    printf("Standby: primary connected, replicating.\n");
+
+    char line[256];
+    while (fgets(line, sizeof(line), in)) {
+        trim_newline(line);
+        if (line[0] == '\0') continue;
+        long seq = repl_apply(accounts, count, book, line, true);
+        if (seq < 0) {
+            printf("Standby: skipped bad record: %s\n", line);
+            /* still acknowledge it, or a synchronous primary would wait forever */
+            if (sscanf(line, "%ld", &seq) != 1) continue;
+        } else if (seq != g_repl.applied_seq + 1) {
+            printf("Standby: sequence gap (expected %ld, got %ld).\n", g_repl.applied_seq + 1, seq);
+        }
+        if (seq > g_repl.applied_seq) g_repl.applied_seq = seq;
+        dprintf(fd, "%ld\n", g_repl.applied_seq);   /* ack on the same connection */
+    }
+    fclose(in);
+    order_book_rebuild(book);
+    repl_flush();
+    printf("Standby: primary disconnected after record %ld. Promoted to primary.\n", g_repl.applied_seq);
+#else
+    (void)accounts; (void)count; (void)book;
+    printf("Standby mode needs Unix-domain sockets; %s not used.\n", path);
+#endif
+}
+
+/* ---------- ledger reconciliation ----------
+   Replays a journal written by --journal into a scratch store and compares
+   the recomputed balances with a snapshot of the live accounts taken at a
+   known sequence number. Records after that point are ignored, so the check
+   stays consistent while the bank keeps running. */
+
+// true if record line names account id as one of its account arguments
+static bool record_mentions(const char *line, const char *id) {
+    char tok[2][16];
+    char op;
+    int n = sscanf(line, "%*s %c %15s %15s", &op, tok[0], tok[1]);
+    if (n >= 2 && strcmp(tok[0], id) == 0) return true;
+    return n >= 3 && op == 'T' && strcmp(tok[1], id) == 0;
+}
+
+// print a journal record with its credential fields (C password/PIN, P PIN) masked
+static void print_record_masked(const char *prefix, const char *line) {
+    char seq[24], id[16], user[64];
+    char op;
+    int n = sscanf(line, "%23s %c %15s %63s", seq, &op, id, user);
+    if (n >= 2 && op == 'C') {
+        printf("%s%s C %s %s **** ******\n", prefix, seq, n >= 3 ? id : "?", n >= 4 ? user : "?");
+    } else if (n >= 2 && op == 'P') {
+        printf("%s%s P %s ******\n", prefix, seq, n >= 3 ? id : "?");
+    } else {
+        printf("%s%s\n", prefix, line);
+    }
+}
+
+static void reconcile_prompt(const Account accounts[], int count) {
+    char path[256];
+    printf("\n--- Reconcile Ledger ---\n");
+    printf("Journal file (written with --journal): ");
+    if (!fgets(path, sizeof(path), stdin)) { printf("Input error.\n"); return; }
+    trim_newline(path);
+
+    /* consistent snapshot: everything up to snap_seq is in the journal */
+    repl_flush();
+    long snap_seq = g_repl.committed_seq;
+    Account snap[MAX_ACCOUNTS];
+    int snap_count = count;
+    memcpy(snap, accounts, sizeof(Account) * (size_t)count);
+
+    FILE *in = fopen(path, "r");
+    if (!in) { printf("Cannot open journal %s.\n", path); return; }
+    static char iobuf[1 << 16];
+    setvbuf(in, iobuf, _IOFBF, sizeof(iobuf));
+
+    Account replay[MAX_ACCOUNTS];
+    int replay_count = 0;
+    long records = 0, bad = 0;
+    char line[256];
+    memset(replay, 0, sizeof(replay));
+
+    while (fgets(line, sizeof(line), in)) {
+        trim_newline(line);
+        if (line[0] == '\0') continue;
+        long seq;
+        if (sscanf(line, "%ld", &seq) == 1 && seq > snap_seq) break;
+        if (repl_apply(replay, &replay_count, NULL, line, false) < 0) {
+            print_record_masked("Unreplayable record: ", line);
+            bad++;
+        }
+        records++;
+    }
+
+    /* ids of every mismatched account, live or journal-only */
+    char flagged[2 * MAX_ACCOUNTS][8];
+    int mismatches = 0;
+    for (int i = 0; i < snap_count; ++i) {
+        int r = find_account_by_id(replay, replay_count, snap[i].account_id);
+        if (r < 0) {
+            printf("Account %s: live balance %.2f, not in journal.\n", snap[i].account_id, snap[i].balance);
+        } else if (replay[r].balance - snap[i].balance > 0.005 || snap[i].balance - replay[r].balance > 0.005) {
+            printf("Account %s: live balance %.2f, journal balance %.2f.\n",
+                   snap[i].account_id, snap[i].balance, replay[r].balance);
+        } else {
+            continue;
+        }
+        strcpy(flagged[mismatches++], snap[i].account_id);
+    }
+    for (int r = 0; r < replay_count; ++r) {
+        if (find_account_by_id(snap, snap_count, replay[r].account_id) < 0) {
+            printf("Account %s: in journal but not in live store.\n", replay[r].account_id);
+            strcpy(flagged[mismatches++], replay[r].account_id);
+        }
+    }
+
+    /* second pass: list the records behind each mismatched account */
+    if (mismatches > 0) {
+        rewind(in);
+        printf("Records for mismatched accounts:\n");
+        while (fgets(line, sizeof(line), in)) {
+            trim_newline(line);
+            long seq;
+            if (sscanf(line, "%ld", &seq) == 1 && seq > snap_seq) break;
+            for (int i = 0; i < mismatches; ++i) {
+                if (record_mentions(line, flagged[i])) {
+                    print_record_masked("  ", line);
+                    break;
+                }
+            }
+        }
+    }
+    fclose(in);
+
+    printf("Replayed %ld record(s) up to seq %ld: %d account(s) checked, %d mismatch(es), %ld bad record(s).\n",
+           records, snap_seq, snap_count, mismatches, bad);
+}
+
+/* show the limit table; reload it from path or move an account to another
+   tier. A tier change needs the account's password and PIN; a wrong pair
+   counts as a failed login attempt. */
+static void limits_prompt(Account accounts[], int count, const char *path) {
+    char buf[32];
+    char pwd[64];
+    char pin_in[16];
+
+    printf("\n--- Limit Policies ---\n");
+    for (int t = 0; t < MAX_TIERS; ++t) {
+        const LimitPolicy *p = &g_limits[t];
+        printf("Tier %d: withdraw max %.2f, %.2f/day, %d/day | transfer max %.2f, %.2f/day, %d/day | combined %d/day\n",
+               t, p->rule[LIMIT_WITHDRAW].per_txn_cap, p->rule[LIMIT_WITHDRAW].daily_amount,
+               p->rule[LIMIT_WITHDRAW].daily_count, p->rule[LIMIT_TRANSFER].per_txn_cap,
+               p->rule[LIMIT_TRANSFER].daily_amount, p->rule[LIMIT_TRANSFER].daily_count,
+               p->combined_daily_count);
+    }
+    printf("Enter R to reload %s, an account ID to change its tier, or blank to go back: ", path);
+    if (!fgets(buf, sizeof(buf), stdin)) { printf("Input error.\n"); return; }
+    trim_newline(buf);
+    if (buf[0] == '\0') return;
+
+    if ((buf[0] == 'R' || buf[0] == 'r') && buf[1] == '\0') {
+        int res = limits_load(path);
+        if (res >= 0) printf("Reloaded %d limit rule(s) from %s.\n", res, path);
+        else if (res == -1) printf("Cannot open %s; limits unchanged.\n", path);
+        else printf("Limits unchanged.\n");
+        return;
+    }
 
-int main() {
+    int idx = find_account_by_id(accounts, count, buf);
+    if (idx < 0) {
+        printf("Account ID not found.\n");
+        return;
+    }
+    if (accounts[idx].frozen) {
+        printf("This account (%s) is frozen; tier unchanged.\n", accounts[idx].account_id);
+        return;
+    }
+    printf("Password: ");
+    if (!fgets(pwd, sizeof(pwd), stdin)) { printf("Input error.\n"); return; }
+    trim_newline(pwd);
+    printf("Enter the account's 6-digit PIN: ");
+    if (!fgets(pin_in, sizeof(pin_in), stdin)) { printf("Input error.\n"); return; }
+    trim_newline(pin_in);
+    if (strcmp(accounts[idx].password, pwd) != 0 || strcmp(accounts[idx].Pin, pin_in) != 0) {
+        accounts[idx].failed_attempts++;
+        if (accounts[idx].failed_attempts >= 3) {
+            accounts[idx].frozen = true;
+            repl_log("F %s", accounts[idx].account_id);
+            printf("Incorrect password or PIN. Account %s has been frozen after 3 failed attempts.\n",
+                   accounts[idx].account_id);
+        } else {
+            printf("Incorrect password or PIN. Tier unchanged.\n");
+        }
+        return;
+    }
+    accounts[idx].failed_attempts = 0;
+    printf("New tier for %s (0-%d, currently %d): ", accounts[idx].account_id, MAX_TIERS - 1, accounts[idx].tier);
+    if (!fgets(buf, sizeof(buf), stdin)) { printf("Input error.\n"); return; }
+    trim_newline(buf);
+    char *endptr;
+    long tier = strtol(buf, &endptr, 10);
+    if (endptr == buf || tier < 0 || tier >= MAX_TIERS) {
+        printf("Invalid tier.\n");
+        return;
+    }
+    accounts[idx].tier = (int)tier;
+    repl_log("L %s %d", accounts[idx].account_id, accounts[idx].tier);
+    printf("Account %s moved to tier %d.\n", accounts[idx].account_id, accounts[idx].tier);
+}
+
+static void replication_status(void) {
+    printf("\n--- Replication Status ---\n");
+    repl_read_acks(false);
+    printf("Sinks: %d (%s, batch size %d)\n", g_repl.sinks,
+           g_repl.batch_size <= 1 ? "synchronous" : "asynchronous", g_repl.batch_size);
+    printf("Committed seq: %ld  Shipped seq: %ld  Unshipped: %ld record(s)\n",
+           g_repl.committed_seq, g_repl.shipped_seq, g_repl.committed_seq - g_repl.shipped_seq);
+    for (int i = 0; i < g_repl.sinks; ++i) {
+        if (g_repl.lost[i]) {
+            printf("Sink %d (%s): LOST after acknowledged seq %ld, not shipping\n", i + 1,
+                   g_repl.name[i], g_repl.acked_seq[i]);
+        } else if (g_repl.ack_fd[i] >= 0) {
+            printf("Standby %d (%s): applied seq %ld, lag %ld record(s)%s\n", i + 1, g_repl.name[i],
+                   g_repl.acked_seq[i], g_repl.committed_seq - g_repl.acked_seq[i],
+                   g_repl.lagging[i] ? ", LAGGING (ack timeout)" : "");
+        } else {
+            printf("Sink %d (%s): journal file\n", i + 1, g_repl.name[i]);
+        }
+    }
+    if (g_repl.applied_seq > 0) printf("Records replayed as standby: %ld\n", g_repl.applied_seq);
+}
+
+/* command line:
+     --primary <socket> ship mutations to the standby listening on socket; repeatable
+     --journal <path>   also write mutations to a journal file (for reconciliation)
+     --batch <n>        flush every n records (asynchronous shipping)
+     --sync             flush every record and wait for standby acks (default)
+     --standby <socket> listen on socket, replay a primary's stream, then take over
+     --limits <path>    limit policy file (default limits.cfg) */
+int main(int argc, char *argv[]) {
     Account accounts[MAX_ACCOUNTS];
     for (int i = 0; i < MAX_ACCOUNTS; ++i) {
         accounts[i].account_id[0] = '\0';
         accounts[i].withdrawals_today = 0;
         accounts[i].failed_attempts = 0;
         accounts[i].frozen = false;
+        accounts[i].tier = 0;
+        limits_reset_day(&accounts[i]);
     }
     int account_count = 0;
+    static OrderBook orders;   /* static: too large for the stack */
+    order_book_init(&orders);
+    static SessionTable sessions;
+    session_table_init(&sessions);
+    const char *standby_path = NULL;
+    const char *limits_path = LIMITS_FILE;
+#ifndef _WIN32
+    signal(SIGPIPE, SIG_IGN);   /* a dead standby or primary shows up as EPIPE, not a kill */
+#endif
+
+    for (int i = 1; i < argc; ++i) {
+        if (strcmp(argv[i], "--primary") == 0 && i + 1 < argc) {
+            if (g_repl.sinks >= MAX_REPLICAS) { printf("Too many sinks (max %d).\n", MAX_REPLICAS); return 1; }
+#ifndef _WIN32
+            if (!repl_connect_standby(argv[++i])) {
+                printf("Cannot connect to a standby on %s (start it with --standby first).\n", argv[i]);
+                return 1;
+            }
+#else
+            printf("--primary needs Unix-domain sockets; use --journal.\n");
+            return 1;
+#endif
+        } else if (strcmp(argv[i], "--journal") == 0 && i + 1 < argc) {
+            if (!repl_open_journal(argv[++i])) { printf("Cannot open journal %s.\n", argv[i]); return 1; }
+        } else if (strcmp(argv[i], "--batch") == 0 && i + 1 < argc) {
+            g_repl.batch_size = atoi(argv[++i]);
+            if (g_repl.batch_size < 1) g_repl.batch_size = 1;
+        } else if (strcmp(argv[i], "--sync") == 0) {
+            g_repl.batch_size = 1;
+        } else if (strcmp(argv[i], "--standby") == 0 && i + 1 < argc) {
+            standby_path = argv[++i];
+        } else if (strcmp(argv[i], "--limits") == 0 && i + 1 < argc) {
+            limits_path = argv[++i];
+        } else {
+            printf("Unknown option: %s\n", argv[i]);
+            return 1;
+        }
+    }
+    atexit(repl_close);
+
+    limits_defaults(g_limits);
+    int rules = limits_load(limits_path);
+    if (rules >= 0) printf("Loaded %d limit rule(s) from %s.\n", rules, limits_path);
+    else if (rules == -2) printf("Using default limits.\n");
 
     srand((unsigned)time(NULL));
     printf("---------- welcome to Community Bank Simulator ----------\n");
+    if (standby_path) run_standby(standby_path, accounts, &account_count, &orders);
 
     while (true) {
         printf("\n----- Account Menu -----\n");
@@ -540,6 +1786,10 @@ int main() {
         printf("3) Simulate new day (reset withdrawals counters)\n");
         printf("4) Manage PIN\n");
         printf("5) Exit\n");
+        printf("6) Replication status\n");
+        printf("7) Resume session\n");
+        printf("8) Reconcile ledger\n");
+        printf("9) Limit policies\n");
         printf("Choose an option: ");
 
         char choice_buf[16];
@@ -549,20 +1799,39 @@ int main() {
 
         if (choice == 1) {
             create_account_prompt(accounts, &account_count);
-        } else if (choice == 2) {
-            if (account_count == 0) {
-                printf("No accounts exist. Please create an account first.\n");
-                continue;
-            }
-            int logged = login_prompt(accounts, account_count);
-            if (logged < 0) {
-                printf("Login failed.\n");
-                continue;
+        } else if (choice == 2 || choice == 7) {
+            SessionToken token = 0;
+            if (choice == 2) {
+                if (account_count == 0) {
+                    printf("No accounts exist. Please create an account first.\n");
+                    continue;
+                }
+                int idx = login_prompt(accounts, account_count);
+                if (idx < 0) {
+                    printf("Login failed.\n");
+                    continue;
+                }
+                token = session_open(&sessions, idx);
+                if (token == 0) {
+                    printf("Cannot open a session (too many active sessions or no random source). Try again later.\n");
+                    continue;
+                }
+                printf("\nLogin successful. Welcome, %s!\n", accounts[idx].username);
+                printf("Session token: %016llx\n", token);
+            } else {
+                char tok_buf[32];
+                printf("Session token: ");
+                if (!fgets(tok_buf, sizeof(tok_buf), stdin)) { printf("Input error.\n"); continue; }
+                trim_newline(tok_buf);
+                token = strtoull(tok_buf, NULL, 16);
             }
 
-            printf("\nLogin successful. Welcome, %s!\n", accounts[logged].username);
-            
             while (true) {
+                int logged = session_account(&sessions, accounts, token);
+                if (logged < 0) {
+                    printf("Session invalid or expired. Please log in again.\n");
+                    break;
+                }
                 printf("\n----- Account Menu -----\n");
                 printf("Username: %s\n", accounts[logged].username);
                 printf("Account ID: %s\n", accounts[logged].account_id);
@@ -573,6 +1842,9 @@ int main() {
                 printf("5) Change PINLogout\n");
                 printf("6) Exit program\n");
                 printf("7) Change PIN\n");   /* added option */
+                printf("8) Schedule transfer / standing order\n");
+                printf("9) View or cancel scheduled transfers\n");
+                printf("10) Switch user (keep this session open)\n");
                 printf("Choose an option: ");
                 if (!fgets(choice_buf, sizeof(choice_buf), stdin)) { printf("Input error.\n"); break; }
                 trim_newline(choice_buf);
@@ -595,21 +1867,27 @@ int main() {
                     if (find_account_by_id(accounts, account_count, to_accid) < 0) { printf("Destination account not found.\n"); continue; }
                     if (strcmp(to_accid, accounts[logged].account_id) == 0) { printf("Cannot transfer to the same account.\n"); continue; }
 
-                    printf("Enter transfer amount (> 0, max 500): ");
+                    const LimitRule *tr_rule = &limits_policy(&accounts[logged])->rule[LIMIT_TRANSFER];
+                    printf("Enter transfer amount (> 0, max %.2f): ", tr_rule->per_txn_cap);
                     if (!fgets(amt_buf, sizeof(amt_buf), stdin)) { printf("Input error.\n"); continue; }
                     trim_newline(amt_buf);
                     char *endptr; double amt = strtod(amt_buf, &endptr);
                     if (endptr == amt_buf || amt <= 0.0) { printf("Invalid amount.\n"); continue; }
 
-                    int tr = transfer_account(accounts, account_count, accounts[logged].account_id, pin_buf, to_accid, amt);
+                    int tr = session_transfer(&sessions, accounts, account_count, token, pin_buf, to_accid, amt);
                     if (tr == 0) {
                         printf("Transfer successful. New balance: %.2f\n", accounts[logged].balance);
                     } else if (tr == -3) {
                         printf("Transfer failed: insufficient funds. Balance: %.2f\n", accounts[logged].balance);
                     } else if (tr == -5) {
-                        printf("Transfer failed: daily transfer/withdrawal limit reached (3).\n");
+                        printf("Transfer failed: daily transfer limit (%d) reached.\n", tr_rule->daily_count);
+                    } else if (tr == -10) {
+                        printf("Transfer failed: combined daily withdrawal/transfer limit (%d) reached.\n",
+                               limits_policy(&accounts[logged])->combined_daily_count);
                     } else if (tr == -6) {
-                        printf("Transfer failed: amount exceeds per-transfer limit (500).\n");
+                        printf("Transfer failed: amount exceeds per-transfer limit (%.2f).\n", tr_rule->per_txn_cap);
+                    } else if (tr == -9) {
+                        printf("Transfer failed: daily transfer amount (%.2f) would be exceeded.\n", tr_rule->daily_amount);
                     } else {
                         printf("Transfer failed (code %d).\n", tr);
                     }
@@ -623,16 +1901,20 @@ int main() {
                     if (strlen(pin_buf) != 6 || strcmp(accounts[logged].Pin, pin_buf) != 0) {
                         printf("Incorrect PIN. Withdrawal cancelled.\n"); continue;
                     }
-                    printf("Enter withdrawal amount (> 0, max 500): ");
+                    const LimitRule *wd_rule = &limits_policy(&accounts[logged])->rule[LIMIT_WITHDRAW];
+                    printf("Enter withdrawal amount (> 0, max %.2f): ", wd_rule->per_txn_cap);
                     if (!fgets(amt_buf, sizeof(amt_buf), stdin)) { printf("Input error.\n"); continue; }
                     trim_newline(amt_buf);
                     char *endptr; double amt = strtod(amt_buf, &endptr);
                     if (endptr == amt_buf || amt <= 0.0) { printf("Invalid amount.\n"); continue; }
-                    int r = withdraw(accounts, account_count, accounts[logged].account_id, pin_buf, amt);
+                    int r = session_withdraw(&sessions, accounts, account_count, token, pin_buf, amt);
                     if (r == 0) printf("Withdrawal successful. New balance: %.2f\n", accounts[logged].balance);
                     else if (r == -3) printf("Insufficient funds. Balance: %.2f\n", accounts[logged].balance);
-                    else if (r == -5) printf("Daily withdrawal limit reached (3). Try next day.\n");
-                    else if (r == -6) printf("Amount exceeds per-withdrawal limit (500).\n");
+                    else if (r == -5) printf("Daily withdrawal limit (%d) reached. Try next day.\n", wd_rule->daily_count);
+                    else if (r == -10) printf("Combined daily withdrawal/transfer limit (%d) reached. Try next day.\n",
+                                              limits_policy(&accounts[logged])->combined_daily_count);
+                    else if (r == -6) printf("Amount exceeds per-withdrawal limit (%.2f).\n", wd_rule->per_txn_cap);
+                    else if (r == -9) printf("Daily withdrawal amount (%.2f) would be exceeded. Try next day.\n", wd_rule->daily_amount);
                     else printf("Withdrawal failed (code %d).\n", r);
 
                 } else if (sub == 3) {
@@ -649,29 +1931,44 @@ int main() {
                     trim_newline(amt_buf);
                     char *endptr; double amt = strtod(amt_buf, &endptr);
                     if (endptr == amt_buf || amt <= 0.0) { printf("Invalid amount.\n"); continue; }
-                    int r = deposit(accounts, account_count, accounts[logged].account_id, amt);
+                    int r = session_deposit(&sessions, accounts, account_count, token, pin_buf, amt);
                     if (r == 0) printf("Deposit successful. New balance: %.2f\n", accounts[logged].balance);
                     else printf("Deposit failed (code %d).\n", r);
 
                 } else if (sub == 4) {
-                    printf("Current balance: %.2f\n", accounts[logged].balance);
-                    printf("Withdrawals today: %d/3\n", accounts[logged].withdrawals_today);
+                    double bal = 0.0;
+                    if (session_balance(&sessions, accounts, token, &bal) != 0) continue;
+                    printf("Current balance: %.2f\n", bal);
+                    printf("Withdrawals/transfers today: %d/%d\n", accounts[logged].withdrawals_today,
+                           limits_policy(&accounts[logged])->combined_daily_count);
                 } else if (sub == 5) {
-                    change_pin_prompt(accounts, logged); 
+                    change_pin_prompt(&sessions, accounts, token);
                 } else if (sub == 6) {
                     printf("Logging out...\n");
+                    session_close(&sessions, token);
                     break;
                 } else if (sub == 7) {
                     printf("Goodbye.\n");
                     return 0;
+                } else if (sub == 8) {
+                    schedule_order_prompt(&orders, accounts, account_count, logged);
+                } else if (sub == 9) {
+                    manage_orders_prompt(&orders, accounts, logged);
+                } else if (sub == 10) {
+                    printf("Session %016llx left open. Resume it from the main menu.\n", token);
+                    break;
                 } else {
                     printf("Invalid choice.\n");
                 }
             }
         } else if (choice == 3) {
            
-            for (int i = 0; i < account_count; ++i) accounts[i].withdrawals_today = 0;
-            printf("New day simulated: withdrawal counters reset for all accounts.\n");
+            for (int i = 0; i < account_count; ++i) limits_reset_day(&accounts[i]);
+            orders.today++;
+            repl_log("N %d", orders.today);
+            printf("New day simulated (day %d): withdrawal counters reset for all accounts.\n", orders.today);
+            int ran = run_due_orders(&orders, accounts, account_count);
+            if (ran > 0) printf("%d scheduled transfer(s) processed.\n", ran);
         } else if (choice == 4) {
             if (account_count == 0) {
                 printf("No accounts available to manage PIN.\n");
@@ -691,6 +1988,12 @@ int main() {
         } else if (choice == 5) {
             printf("Goodbye.\n");
             break;
+        } else if (choice == 6) {
+            replication_status();
+        } else if (choice == 8) {
+            reconcile_prompt(accounts, account_count);
+        } else if (choice == 9) {
+            limits_prompt(accounts, account_count, limits_path);
         } else {
             printf("Invalid option.\n");
         }